@@ -0,0 +1,94 @@
+/*
+ * alert_queue.cc -- 'AlertQueue' class implementation.
+ *
+ * Copyright (C) 2018  Gabriel Szasz <gabriel.szasz1@gmail.com>
+ *
+ * This file is part of FIFO-inventory
+ *
+ * FIFO-inventory is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * FIFO-inventory is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * FIFO-inventory.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>  // required for 'chrono::milliseconds'
+#include "alert_queue.hh"
+
+using namespace std;
+
+// Default constructor
+AlertQueue::AlertQueue() {
+    mHead.store(0);
+    mTail.store(0);
+    mDropped.store(0);
+    mWoken = false;
+}
+
+// Append alert to the back.  The slot is filled first and only then the tail
+// is published with release ordering, so the consumer never sees a half
+// written alert.  The consumer can only be asleep on an empty queue, so it is
+// signalled only when the first alert arrives.
+bool AlertQueue::push(const Alert& alert) {
+    unsigned tail = mTail.load(memory_order_relaxed);
+    unsigned next = (tail + 1) % alert_queue::CAPACITY;
+    unsigned head = mHead.load(memory_order_acquire);
+    if (next == head) {
+        mDropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    mSlot[tail] = alert;
+    mTail.store(next, memory_order_release);
+    if (tail == head)
+        mWaitCond.notify_one();
+    return true;
+}
+
+// Remove the oldest alert from the front
+bool AlertQueue::pop(Alert& alert) {
+    unsigned head = mHead.load(memory_order_relaxed);
+    if (head == mTail.load(memory_order_acquire))
+        return false;
+    alert = mSlot[head];
+    mHead.store((head + 1) % alert_queue::CAPACITY, memory_order_release);
+    return true;
+}
+
+// Sleep until alerts arrive, wake() is called or 'alert_queue::WAIT_MS' passes
+void AlertQueue::wait() {
+    unique_lock<mutex> lock(mWaitMutex);
+    while (empty() && !mWoken) {
+        if (mWaitCond.wait_for(lock, chrono::milliseconds(alert_queue::WAIT_MS)) == cv_status::timeout)
+            break;
+    }
+    mWoken = false;
+}
+
+// Wake up the consumer sleeping in wait()
+void AlertQueue::wake() {
+    lock_guard<mutex> lock(mWaitMutex);
+    mWoken = true;
+    mWaitCond.notify_all();
+}
+
+// Test whether the queue is empty
+bool AlertQueue::empty() const {
+    return (mHead.load(memory_order_acquire) == mTail.load(memory_order_acquire));
+}
+
+// Return number of alerts lost due to full queue
+unsigned AlertQueue::dropped() const {
+    return mDropped.load(memory_order_relaxed);
+}
+
+// Return number of alerts lost due to full queue and reset it
+unsigned AlertQueue::takeDropped() {
+    return mDropped.exchange(0, memory_order_relaxed);
+}
@@ -0,0 +1,83 @@
+/*
+ * alert_queue.hh -- 'AlertQueue' class header file.
+ *
+ * Copyright (C) 2018  Gabriel Szasz <gabriel.szasz1@gmail.com>
+ *
+ * This file is part of FIFO-inventory
+ *
+ * FIFO-inventory is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * FIFO-inventory is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * FIFO-inventory.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALERT_QUEUE_HH
+#define ALERT_QUEUE_HH
+
+#include <atomic>              // required for 'std::atomic'
+#include <mutex>               // required for 'std::mutex'
+#include <condition_variable>  // required for 'std::condition_variable'
+
+namespace alert_queue {
+    const unsigned CAPACITY = 1024;  // maximum number of pending alerts
+    const int WAIT_MS = 50;          // longest sleep of a waiting consumer
+}
+
+// types of conditions watched by a trigger
+enum TriggerType {
+    TRIGGER_UNITS,  // units in the inventory fell below the threshold
+    TRIGGER_PRICE,  // price of the oldest batch rose above the threshold
+    TRIGGER_VALUE   // total value of the inventory crossed the threshold
+};
+
+// declaration of a structure holding single alert
+struct Alert {
+    int item;          // code of item
+    TriggerType type;  // condition that fired
+    float threshold;   // threshold of the trigger
+    float value;       // value which fired the trigger
+};
+
+// Lock-free bounded FIFO queue of alerts for a single producer and a single
+// consumer.  The producer only ever moves the tail and the consumer only ever
+// moves the head, so no locking is needed.  One slot is kept free to tell a
+// full queue from an empty one.  When the queue is full, new alerts are dropped
+// and counted; the producer never waits for the consumer.
+//
+// A consumer thread can sleep in wait() until alerts arrive.  The producer
+// signals it without taking the lock, so a wakeup may be missed; the sleep is
+// therefore bounded by 'alert_queue::WAIT_MS'.
+class AlertQueue {
+
+private:
+    Alert mSlot[alert_queue::CAPACITY];  // ring buffer of alerts
+    std::atomic<unsigned> mHead;         // index of the oldest alert
+    std::atomic<unsigned> mTail;         // index of the next free slot
+    std::atomic<unsigned> mDropped;      // alerts lost due to full queue
+    std::mutex mWaitMutex;               // lock for 'mWaitCond'
+    std::condition_variable mWaitCond;   // signals arrival of alerts
+    bool mWoken;                         // wake() was called
+
+public:
+    AlertQueue();  // default constructor
+
+    bool push(const Alert& alert);  // append alert, false if queue is full
+    bool pop(Alert& alert);         // remove the oldest alert, false if empty
+
+    void wait();  // sleep until alerts arrive or wake() is called
+    void wake();  // wake up the consumer sleeping in wait()
+
+    bool empty() const;        // test whether the queue is empty
+    unsigned dropped() const;  // number of alerts lost due to full queue
+    unsigned takeDropped();    // return and reset number of lost alerts
+};
+
+#endif  // ALERT_QUEUE_HH
@@ -28,86 +28,244 @@ using namespace std;
 
 // Default constructor
 Inventory::Inventory() {
-    for (int i = 0; i < inventory::MAX_ITEMS; i++)
+    for (int i = 0; i < inventory::MAX_ITEMS; i++) {
         mTotalUnits[i] = 0;
+        mTotalValue[i] = 0;
+        mTriggerCount[i] = 0;
+    }
+    mPolicy = POLICY_SKIP;
+    mLastError = REJECT_NONE;
 }
 
 // Buy batch of units
 bool Inventory::buy(int item, int units, float cost) {
-    if (item > inventory::MAX_ITEMS) {
-        cout << item << ": item out of range." << endl;
+    if (item < 1 || item > inventory::MAX_ITEMS) {
+        mLastError = REJECT_ITEM;
         return false;
     }
     else if (units <= 0) {
-        cout << units << ": invalid number of units" << endl;
+        mLastError = REJECT_UNITS;
+        return false;
+    }
+    else if (cost < 0) {
+        mLastError = REJECT_PRICE;
         return false;
     }
     mTotalUnits[item-1] += units;
+    mTotalValue[item-1] += double(units) * cost;
     mQueue[item-1].emplace(units, cost);
 
     mLog.add(item, 'B', units, cost);
+    mLastError = REJECT_NONE;
+    checkTriggers(item);
     return true;
 }
 
 // Sell units from the inventory
 float Inventory::sell(int item, int units, float price) {
-    if (item > inventory::MAX_ITEMS) {
-        cout << item << ": item out of range." << endl;
+    if (item < 1 || item > inventory::MAX_ITEMS) {
+        mLastError = REJECT_ITEM;
         return -1;
     }
-    else if (units > mTotalUnits[item-1]) {
-        cout << units << ": not enough units in the inventory (units available: " << mTotalUnits[item-1] << ")" << endl;
+    else if (units <= 0) {
+        mLastError = REJECT_UNITS;
         return -1;
     }
-    else if (units <= 0) {
-        cout << units << ": invalid number of units" << endl;
+    else if (price < 0) {
+        mLastError = REJECT_PRICE;
+        return -1;
+    }
+    else if (units > mTotalUnits[item-1]) {
+        mLastError = REJECT_STOCK;
         return -1;
     }
     mTotalUnits[item-1] -= units;
-    float cogs = 0;
+    double cogs = 0;
     int remainingUnits = units;
     // mQueue[item-1].front() returns reference to Batch.  Since the reference in
     // C++ cannot be changed once assigned to variable, we need convert it to
     // pointer here, otherwise batch could not be reassigned during iterations.
     Batch* batch = &(mQueue[item-1].front());
     while (remainingUnits >= batch->units) {
-        cogs += batch->units * batch->price;
+        cogs += double(batch->units) * batch->price;
         remainingUnits -= batch->units;
         mQueue[item-1].pop();
+        // selling out the whole inventory leaves no batch to look at
+        if (mQueue[item-1].empty())
+            break;
         batch = &(mQueue[item-1].front());
     }
     if (remainingUnits > 0) {
-        cogs += remainingUnits * batch->price;
+        cogs += double(remainingUnits) * batch->price;
         batch->units -= remainingUnits;
     }
+    mTotalValue[item-1] -= cogs;
+    // The running sum is kept in double to stay close to the sum printStats()
+    // computes.  It may still differ by a rounding error, so value triggers
+    // may fire slightly off their threshold.  Drop the residue once sold out.
+    if (mTotalUnits[item-1] == 0)
+        mTotalValue[item-1] = 0;
     mLog.add(item, 'S', units, price);
-    return cogs;
+    mLastError = REJECT_NONE;
+    checkTriggers(item);
+    return float(cogs);
 }
 
-// Execute set of transactions from the transaction backlog
+// Execute set of transactions from the transaction backlog.  Rejected
+// transactions are collected in the rejection log instead of being reported
+// one by one; see printRejections() and dumpRejections().  If the backlog is
+// being read in background, records are executed as soon as they arrive.
 void Inventory::execute(TransactionBuffer& backlog) {
-    stringstream& backlogStream = backlog.getStream();
     string line;
-    while (getline(backlogStream, line)) {
+    int lineNumber = 0;
+    mRejects.clear();
+    while (backlog.getLine(line)) {
+        lineNumber++;
         Transaction t = { 0, '\0', 0, 0.0 };
-        sscanf(line.c_str(), "%d%c %d %f", &t.item, &t.type, &t.units, &t.price);
-        switch(t.type) {
-        case 'B':
-            buy(t.item, t.units, t.price);
+        int fields = sscanf(line.c_str(), "%d%c %d %f", &t.item, &t.type, &t.units, &t.price);
+        // A sale can legitimately return a negative COGS, so success is told
+        // by the error code rather than by the returned value.
+        if (fields == 4) {
+            switch(t.type) {
+            case 'B':
+                buy(t.item, t.units, t.price);
+                break;
+            case 'S':
+                sell(t.item, t.units, t.price);
+                break;
+            default:
+                mLastError = REJECT_TRANSACTION;
+                break;
+            }
+        }
+        else
+            mLastError = REJECT_TRANSACTION;
+
+        if (mLastError != REJECT_NONE) {
+            mRejects.add(lineNumber, mLastError, line);
+            if (mPolicy == POLICY_STOP)
+                break;
+        }
+    }
+}
+
+// Write transaction log to file in background.  The call returns before the
+// file is complete, so waitLog() must be called before the same file is read
+// or written by anything else.
+void Inventory::dumpLog(const string& filename) {
+    mLog.writeAsync(filename);
+}
+
+// Wait for the background write of the transaction log to finish
+void Inventory::waitLog() {
+    mLog.wait();
+}
+
+// Set handling of rejected transactions
+void Inventory::setPolicy(RejectPolicy policy) {
+    mPolicy = policy;
+    mRejects.setQuarantine(policy == POLICY_QUARANTINE);
+}
+
+// Get handling of rejected transactions
+RejectPolicy Inventory::getPolicy() const {
+    return mPolicy;
+}
+
+// Return reason of the last failed buy() or sell()
+RejectCode Inventory::lastError() const {
+    return mLastError;
+}
+
+// Register trigger watching given item.  The trigger starts in the state given
+// by the current inventory, so it fires only on a later change.
+bool Inventory::addTrigger(int item, TriggerType type, float threshold) {
+    if (item < 1 || item > inventory::MAX_ITEMS)
+        return false;
+    else if (mTriggerCount[item-1] >= inventory::MAX_TRIGGERS)
+        return false;
+    Trigger& t = mTrigger[item-1][mTriggerCount[item-1]];
+    t.type = type;
+    t.threshold = threshold;
+    t.holds = testTrigger(item, t);
+    mTriggerCount[item-1]++;
+    return true;
+}
+
+// Test whether any trigger is registered
+bool Inventory::hasTriggers() const {
+    for (int i = 0; i < inventory::MAX_ITEMS; i++) {
+        if (mTriggerCount[i] > 0)
+            return true;
+    }
+    return false;
+}
+
+// Get reference to the queue of alerts
+AlertQueue& Inventory::getAlerts() {
+    return mAlerts;
+}
+
+// Test condition of the trigger against the current state of the item
+bool Inventory::testTrigger(int item, const Trigger& t) const {
+    switch (t.type) {
+    case TRIGGER_UNITS:
+        return (mTotalUnits[item-1] < t.threshold);
+    case TRIGGER_PRICE:
+        return (!mQueue[item-1].empty() && mQueue[item-1].front().price > t.threshold);
+    case TRIGGER_VALUE:
+        return (mTotalValue[item-1] > t.threshold);
+    default:
+        return false;
+    }
+}
+
+// Evaluate triggers of the item touched by buy() or sell().  Units and price
+// triggers fire when their condition starts to hold, value triggers fire on
+// crossing the threshold in either direction.
+void Inventory::checkTriggers(int item) {
+    for (int i = 0; i < mTriggerCount[item-1]; i++) {
+        Trigger& t = mTrigger[item-1][i];
+        bool holds = testTrigger(item, t);
+        bool fire = (holds != t.holds) && (holds || t.type == TRIGGER_VALUE);
+        t.holds = holds;
+        if (!fire)
+            continue;
+
+        Alert a;
+        a.item = item;
+        a.type = t.type;
+        a.threshold = t.threshold;
+        switch (t.type) {
+        case TRIGGER_UNITS:
+            a.value = mTotalUnits[item-1];
             break;
-        case 'S':
-            sell(t.item, t.units, t.price);
+        case TRIGGER_PRICE:
+            a.value = mQueue[item-1].front().price;
             break;
         default:
-            cout << line << ": invalid transaction" << endl;
+            a.value = mTotalValue[item-1];
             break;
         }
+        mAlerts.push(a);
     }
 }
 
-// Write transaction log to file
-void Inventory::dumpLog(const string& filename) const {
-    mLog.write(filename);
+// Return number of units of the item in stock
+int Inventory::getUnits(int item) const {
+    if (item < 1 || item > inventory::MAX_ITEMS)
+        return 0;
+    return mTotalUnits[item-1];
+}
+
+// Print transactions rejected by the last execution
+void Inventory::printRejections() const {
+    mRejects.print();
+}
+
+// Write quarantined transactions to file
+void Inventory::dumpRejections(const string& filename) const {
+    mRejects.write(filename);
 }
 
 // Print statistics
@@ -130,7 +288,7 @@ void Inventory::printStats() const {
 
 // Print item's inventory
 void Inventory::printItem(int i) const {
-    if (i > inventory::MAX_ITEMS) {
+    if (i < 1 || i > inventory::MAX_ITEMS) {
         cout << i << ": item out of range." << endl;
         return;
     }
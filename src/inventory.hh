@@ -24,17 +24,38 @@
 
 #include "inventory_queue.hh"     // required for 'InventoryQueue'
 #include "transaction_buffer.hh"  // required for 'TransactionBuffer'
+#include "rejection_log.hh"       // required for 'RejectionLog'
+#include "alert_queue.hh"         // required for 'AlertQueue'
 
 namespace inventory {
     const int MAX_ITEMS = 3;
+    const int MAX_TRIGGERS = 8;  // maximum number of triggers per item
 }
 
+// declaration of a structure holding single registered trigger
+struct Trigger {
+    TriggerType type;  // watched condition
+    float threshold;   // threshold of the condition
+    bool holds;        // whether the condition held after the last check
+};
+
 class Inventory {
 
 private:
     InventoryQueue mQueue[inventory::MAX_ITEMS];
     int mTotalUnits[inventory::MAX_ITEMS];
+    double mTotalValue[inventory::MAX_ITEMS];  // total cost of units in stock
     TransactionBuffer mLog;
+    RejectionLog mRejects;    // transactions rejected by last execute()
+    RejectPolicy mPolicy;     // handling of rejected transactions
+    RejectCode mLastError;    // reason of the last failed buy() or sell()
+
+    Trigger mTrigger[inventory::MAX_ITEMS][inventory::MAX_TRIGGERS];
+    int mTriggerCount[inventory::MAX_ITEMS];
+    AlertQueue mAlerts;       // alerts fired by the triggers
+
+    bool testTrigger(int item, const Trigger& t) const;  // test condition
+    void checkTriggers(int item);  // evaluate triggers of the touched item
 
 public:
     Inventory();                                // default constructor
@@ -48,8 +69,26 @@ public:
     // execute set of transactions
     void execute(TransactionBuffer& backlog);
 
-    // write transaction log to file
-    void dumpLog(const std::string& filename) const;
+    // write transaction log to file in background
+    void dumpLog(const std::string& filename);
+    void waitLog();  // wait for the background write of the log
+
+    void setPolicy(RejectPolicy policy);  // set handling of rejections
+    RejectPolicy getPolicy() const;       // get handling of rejections
+    RejectCode lastError() const;         // reason of the last failure
+    int getUnits(int item) const;         // units of the item in stock
+
+    // register trigger watching given item
+    bool addTrigger(int item, TriggerType type, float threshold);
+
+    bool hasTriggers() const;  // test whether any trigger is registered
+    AlertQueue& getAlerts();   // get reference to the queue of alerts
+
+    // print transactions rejected by the last execution
+    void printRejections() const;
+
+    // write quarantined transactions to file
+    void dumpRejections(const std::string& filename) const;
 
     void printStats() const;                    // print statistics
     void printItem(int item) const;      // print item's inventory
@@ -82,6 +82,11 @@ Batch& InventoryQueue::front() {
     return mHead->data;
 }
 
+// Return read-only reference to the data of the front node
+const Batch& InventoryQueue::front() const {
+    return mHead->data;
+}
+
 // Return reference to the date of the back node
 Batch& InventoryQueue::back() {
     return mTail->data;
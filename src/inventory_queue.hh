@@ -55,6 +55,7 @@ public:
     void emplace(int units, float price);
 
     Batch& front();  // return reference to the data of the head node
+    const Batch& front() const;  // read-only variant of front()
     Batch& back();   // return reference to the date of the tail node
 
     int size() const;     // return number of nodes in the queue
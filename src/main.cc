@@ -22,6 +22,9 @@
 #include <iostream>  // required for 'cout', 'cin', << and >>
 #include <iomanip>   // required for 'fixed' and 'setprecision'
 #include <string>    // required for 'string'
+#include <sstream>   // required for 'stringstream'
+#include <thread>    // required for 'thread'
+#include <atomic>    // required for 'atomic'
 #include "inventory.hh"
 
 using namespace std;
@@ -37,6 +40,27 @@ void listInventoryDialog(Inventory& i) {
     i.printItem(item);
 }
 
+// Print reason of the last failed buy or sale together with the offending value
+void printError(Inventory& i, int item, int units, float price) {
+    switch (i.lastError()) {
+    case REJECT_ITEM:
+        cout << item << ": item out of range." << endl;
+        break;
+    case REJECT_UNITS:
+        cout << units << ": invalid number of units" << endl;
+        break;
+    case REJECT_STOCK:
+        cout << units << ": not enough units in the inventory (units available: " << i.getUnits(item) << ")" << endl;
+        break;
+    case REJECT_PRICE:
+        cout << price << ": invalid price per unit" << endl;
+        break;
+    default:
+        cout << RejectionLog::describe(i.lastError()) << endl;
+        break;
+    }
+}
+
 // Interactive dialog for buying an inventory item
 void purchaseDialog(Inventory& i) {
     int item = 1;       // item
@@ -57,6 +81,8 @@ void purchaseDialog(Inventory& i) {
         cout << "------------------------------" << endl;
         cout << "Total Cost\t" << fixed << setprecision(2) << totalCost << " EUR" << endl;
     }
+    else
+        printError(i, item, units, cost);
 }
 
 // Interactive dialog for selling an inventory item
@@ -73,7 +99,7 @@ void saleDialog(Inventory& i) {
     cin >> price;
     cout << endl;
     float cogs = i.sell(item, units, price);
-    if (cogs > 0) {
+    if (i.lastError() == REJECT_NONE) {
         float totalCost = units * price;
         cout << units << "\t@\t" << fixed << setprecision(2) << price << " EUR" << endl;
         cout << "------------------------------" << endl;
@@ -82,6 +108,107 @@ void saleDialog(Inventory& i) {
         cout << "------------------------------" << endl;
         cout << "Gross Profit\t" << fixed << setprecision(2) << totalCost - cogs << " EUR" << endl;
     }
+    else
+        printError(i, item, units, price);
+}
+
+// Interactive dialog for registering an alert trigger
+void triggerDialog(Inventory& i) {
+    int item = 1;           // item
+    char type = 'u';        // watched condition
+    float threshold = 0.0;  // threshold of the condition
+
+    cout << "Item (1-" << inventory::MAX_ITEMS << "): ";
+    cin >> item;
+    cout << "Alert when (u = units below, p = oldest price above, v = total value crosses): ";
+    cin >> type;
+    cout << "Threshold: ";
+    cin >> threshold;
+    cout << endl;
+
+    bool added = false;
+    switch (type) {
+    case 'u':
+        added = i.addTrigger(item, TRIGGER_UNITS, threshold);
+        break;
+    case 'p':
+        added = i.addTrigger(item, TRIGGER_PRICE, threshold);
+        break;
+    case 'v':
+        added = i.addTrigger(item, TRIGGER_VALUE, threshold);
+        break;
+    default:
+        cout << type << ": unknown condition" << endl;
+        return;
+    }
+    if (!added)
+        cout << item << ": item out of range or too many triggers" << endl;
+}
+
+// Print and remove pending alerts.  Alerts are formatted into a local buffer
+// and written out at once, so the queue is drained faster than it would be
+// with a flushed write per alert.
+void printAlerts(Inventory& i) {
+    AlertQueue& alerts = i.getAlerts();
+    if (alerts.empty() && alerts.dropped() == 0)
+        return;
+    stringstream report;
+    report << fixed << setprecision(2);
+    Alert a;
+    while (alerts.pop(a)) {
+        report << "Alert: item " << a.item << ": ";
+        switch (a.type) {
+        case TRIGGER_UNITS:
+            report << "units below " << int(a.threshold) << " (" << int(a.value) << " left)";
+            break;
+        case TRIGGER_PRICE:
+            report << "oldest price above " << a.threshold << " EUR (" << a.value << " EUR)";
+            break;
+        case TRIGGER_VALUE:
+            report << "total value crossed " << a.threshold << " EUR (" << a.value << " EUR)";
+            break;
+        }
+        report << '\n';
+    }
+    unsigned dropped = alerts.takeDropped();
+    if (dropped > 0)
+        report << "Alert: " << dropped << " alerts lost due to full queue" << '\n';
+    if (report.tellp() > 0)
+        cout << report.str() << flush;
+}
+
+// Print alerts while the inventory is busy executing a backlog, so that the
+// alert queue does not fill up on long runs.  Sleeps while there are none.
+void watchAlerts(Inventory* i, atomic<bool>* done) {
+    AlertQueue& alerts = i->getAlerts();
+    while (!done->load()) {
+        alerts.wait();
+        printAlerts(*i);
+    }
+}
+
+// Interactive dialog for choosing handling of rejected transactions
+void policyDialog(Inventory& i) {
+    char policy = 's';  // policy
+
+    cout << "Rejected transactions (s = skip, t = stop, q = quarantine): ";
+    cin >> policy;
+    cout << endl;
+
+    switch (policy) {
+    case 's':
+        i.setPolicy(POLICY_SKIP);
+        break;
+    case 't':
+        i.setPolicy(POLICY_STOP);
+        break;
+    case 'q':
+        i.setPolicy(POLICY_QUARANTINE);
+        break;
+    default:
+        cout << policy << ": unknown policy";
+        break;
+    }
 }
 
 // Main program
@@ -104,9 +231,14 @@ int main(int argc, char **argv) {
         "  Queue operations\n"
         "   b    'buy' specified amount of units of the selected item\n"
         "   s    'sell' specified amount of units of the selected item\n\n"
+        "  Alerts\n"
+        "   a    alert when units, oldest price or total value of the item\n"
+        "        reach a threshold\n\n"
         "  Load & Save\n"
         "   r    read inventory from file ('inventory.txt')\n"
-        "   w    write inventory to file ('inventory.txt')\n\n"
+        "   w    write inventory to file ('inventory.txt')\n"
+        "   e    set handling of rejected transactions (skip, stop, quarantine\n"
+        "        to 'inventory.rej')\n\n"
         "  Exiting\n"
         "   q    quit program\n\n"
         "  License\n"
@@ -159,18 +291,44 @@ int main(int argc, char **argv) {
             break;
         case 'b':  // 'buy' specified amount of units of the selected item
             purchaseDialog(inventory);
+            printAlerts(inventory);
             break;
         case 's':  // 'sell' specified amount of units of the selected item
             saleDialog(inventory);
+            printAlerts(inventory);
             break;
         case 'r':  // read inventory from file ('inventory.txt')
-            backlog.read("inventory.txt");
-            inventory.execute(backlog);
+            // the log may still be being written to the same file
+            inventory.waitLog();
+            backlog.readAsync("inventory.txt");
+            {
+                // alerts are watched only if any trigger can fire them
+                atomic<bool> done(false);
+                thread watcher;
+                if (inventory.hasTriggers())
+                    watcher = thread(watchAlerts, &inventory, &done);
+                inventory.execute(backlog);
+                done.store(true);
+                if (watcher.joinable()) {
+                    inventory.getAlerts().wake();
+                    watcher.join();
+                }
+            }
             backlog.clear();
+            printAlerts(inventory);
+            inventory.printRejections();
+            if (inventory.getPolicy() == POLICY_QUARANTINE)
+                inventory.dumpRejections("inventory.rej");
             break;
         case 'w':  // write inventory to file ('inventory.txt')
             inventory.dumpLog("inventory.txt");
             break;
+        case 'a':  // register alert trigger
+            triggerDialog(inventory);
+            break;
+        case 'e':  // set handling of rejected transactions
+            policyDialog(inventory);
+            break;
         case 'q':  // quit program
             break;
         case 'd':  // show warranty disclaimer
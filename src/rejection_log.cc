@@ -0,0 +1,124 @@
+/*
+ * rejection_log.cc -- 'RejectionLog' class implementation.
+ *
+ * Copyright (C) 2018  Gabriel Szasz <gabriel.szasz1@gmail.com>
+ *
+ * This file is part of FIFO-inventory
+ *
+ * FIFO-inventory is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * FIFO-inventory is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * FIFO-inventory.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>  // required for 'cout' and <<
+#include <fstream>   // required for 'ofstream'
+#include "rejection_log.hh"
+
+using namespace std;
+
+// Default constructor
+RejectionLog::RejectionLog() {
+    for (int i = 0; i < REJECT_CODES; i++)
+        mCount[i] = 0;
+    mTotal = 0;
+    mKeepQuarantine = false;
+}
+
+// Add rejection record to the log via 'Rejection' structure
+void RejectionLog::add(Rejection r) {
+    // Records are terminated by '\n' rather than 'endl', the buffer is written
+    // out at once by print().
+    mBuffer << r.line << ":" << r.code << ":" << r.text << '\n';
+    if (mKeepQuarantine)
+        mQuarantine << r.text << '\n';
+    mCount[r.code]++;
+    mTotal++;
+}
+
+// Add rejection record to the log via arguments
+void RejectionLog::add(int line, RejectCode code, const string& text) {
+    Rejection r;
+    r.line = line;  // line number within the backlog
+    r.code = code;  // reason of the rejection
+    r.text = text;  // original text of the transaction record
+
+    add(r);  // call add(Rejection r) member function
+}
+
+// Keep original text of rejected records for write().  It is off by default,
+// so that skipped records are not stored twice.
+void RejectionLog::setQuarantine(bool keep) {
+    mKeepQuarantine = keep;
+}
+
+// Return number of rejections with given code
+int RejectionLog::count(RejectCode code) const {
+    return mCount[code];
+}
+
+// Return total number of rejections
+int RejectionLog::total() const {
+    return mTotal;
+}
+
+// Print rejection records followed by per-code counters
+void RejectionLog::print() const {
+    if (mTotal == 0)
+        return;
+
+    stringstream report;
+    report << mBuffer.str();
+    for (int i = REJECT_NONE + 1; i < REJECT_CODES; i++) {
+        if (mCount[i] > 0)
+            report << mCount[i] << "\t" << describe(RejectCode(i)) << '\n';
+    }
+    report << mTotal << "\trejected in total" << '\n';
+    cout << report.str() << flush;
+}
+
+// Write original text of the rejected records to file
+void RejectionLog::write(const string& filename) const {
+    ofstream outputFile(filename.c_str());
+    outputFile << mQuarantine.str();
+    outputFile.close();
+}
+
+// Clear records and counters
+void RejectionLog::clear() {
+    mBuffer.str("");
+    mBuffer.clear();
+    mQuarantine.str("");
+    mQuarantine.clear();
+    for (int i = 0; i < REJECT_CODES; i++)
+        mCount[i] = 0;
+    mTotal = 0;
+}
+
+// Return human readable description of the rejection code
+const char* RejectionLog::describe(RejectCode code) {
+    switch (code) {
+    case REJECT_NONE:
+        return "accepted";
+    case REJECT_ITEM:
+        return "item out of range";
+    case REJECT_UNITS:
+        return "invalid number of units";
+    case REJECT_STOCK:
+        return "not enough units in the inventory";
+    case REJECT_TRANSACTION:
+        return "invalid transaction";
+    case REJECT_PRICE:
+        return "invalid price per unit";
+    default:
+        return "unknown error";
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * rejection_log.hh -- 'RejectionLog' class header file.
+ *
+ * Copyright (C) 2018  Gabriel Szasz <gabriel.szasz1@gmail.com>
+ *
+ * This file is part of FIFO-inventory
+ *
+ * FIFO-inventory is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * FIFO-inventory is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * FIFO-inventory.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef REJECTION_LOG_HH
+#define REJECTION_LOG_HH
+
+#include <sstream>  // required for 'std::stringstream'
+#include <string>   // required for 'std::string'
+
+// codes of the reasons why a transaction can be rejected
+enum RejectCode {
+    REJECT_NONE = 0,     // transaction accepted
+    REJECT_ITEM,         // item out of range
+    REJECT_UNITS,        // invalid number of units
+    REJECT_STOCK,        // not enough units in the inventory
+    REJECT_TRANSACTION,  // malformed transaction record
+    REJECT_PRICE,        // negative price per unit
+    REJECT_CODES         // number of codes (not a valid code)
+};
+
+// policies for handling rejected transactions during execution of a backlog
+enum RejectPolicy {
+    POLICY_SKIP,        // skip rejected transaction and continue
+    POLICY_STOP,        // stop execution at the first rejected transaction
+    POLICY_QUARANTINE   // skip it and keep its original text for quarantine
+};
+
+// declaration of a structure holding single rejected transaction
+struct Rejection {
+    int line;           // line number within the backlog
+    RejectCode code;    // reason of the rejection
+    std::string text;   // original text of the transaction record
+};
+
+// Collects rejected transactions and writes them out in bulk, so that dirty
+// input does not pay for a flushed console write per bad record.
+class RejectionLog {
+private:
+    std::stringstream mBuffer;      // compact "line:code:text" records
+    std::stringstream mQuarantine;  // original text of rejected records
+    int mCount[REJECT_CODES];       // number of rejections per code
+    int mTotal;                     // total number of rejections
+    bool mKeepQuarantine;           // whether 'mQuarantine' is filled
+
+public:
+    RejectionLog();  // default constructor
+
+    void add(Rejection r);  // add rejection record to the log
+    void add(int line, RejectCode code, const std::string& text);
+
+    // keep original text of rejected records for write()
+    void setQuarantine(bool keep);
+
+    int count(RejectCode code) const;  // number of rejections with given code
+    int total() const;                 // total number of rejections
+
+    void print() const;                             // print records and counters
+    void write(const std::string& filename) const;  // write quarantine to file
+
+    void clear();  // clear records and counters
+
+    // return human readable description of the rejection code
+    static const char* describe(RejectCode code);
+};
+
+#endif  // REJECTION_LOG_HH
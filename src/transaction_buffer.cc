@@ -28,16 +28,23 @@ using namespace std;
 
 // Default constructor
 TransactionBuffer::TransactionBuffer() {
-    // To keep default constructor accessible while having also defined a
-    // parameterized constructor, it is necessary to explicitly define an empty
-    // argumentless constructor.
+    mReadDone = true;
+    mWritten = 0;
 }
 
 // Construct object from given string
 TransactionBuffer::TransactionBuffer(const string& s) {
+    mReadDone = true;
+    mWritten = 0;
     mBuffer << s;
 }
 
+// Explicit destructor.  Background threads refer to the buffer, so they must
+// finish before it is destroyed.
+TransactionBuffer::~TransactionBuffer() {
+    wait();
+}
+
 // Add transaction record to buffer via 'Transaction' structure
 void TransactionBuffer::add(Transaction t) {
     mBuffer << t.item << t.type << " " << t.units << " " << fixed << setprecision(2) << t.price << endl;
@@ -59,13 +66,26 @@ stringstream& TransactionBuffer::getStream()  {
     return mBuffer;
 }
 
+// Get next record from the buffer.  While the background reader is running,
+// the call blocks until the next record arrives.  Returns false when there are
+// no more records.
+bool TransactionBuffer::getLine(string& line) {
+    unique_lock<mutex> lock(mReadMutex);
+    while (!getline(mBuffer, line)) {
+        // The reader appends whole lines only, so a failed getline() means
+        // that the stream is exhausted for now.
+        mBuffer.clear();
+        if (mReadDone)
+            return false;
+        mReadCond.wait(lock);
+    }
+    return true;
+}
+
 // Read buffer from file
 void TransactionBuffer::read(const string& filename) {
-    ifstream inputFile(filename.c_str());
-    string line;
-    while (getline(inputFile, line))
-        mBuffer << line << endl;
-    inputFile.close();
+    readAsync(filename);
+    mReader.join();
 }
 
 // Write buffer to file
@@ -75,8 +95,101 @@ void TransactionBuffer::write(const string& filename) const {
     outputFile.close();
 }
 
+// Start reading buffer from file in background
+void TransactionBuffer::readAsync(const string& filename) {
+    if (mReader.joinable())
+        mReader.join();
+    mReadDone = false;
+    mReader = thread(&TransactionBuffer::readChunks, this, filename);
+}
+
+// Start writing buffer to file in background.  Only the records added since
+// the previous write are copied to the write buffer, which still holds the
+// earlier ones, and the writer rewrites the whole file from it.  Records can
+// be added while the file is being written.  If the previous write is still
+// in progress, wait for it first.
+void TransactionBuffer::writeAsync(const string& filename) {
+    if (mWriter.joinable())
+        mWriter.join();
+    {
+        lock_guard<mutex> lock(mReadMutex);
+        streamoff size = mBuffer.tellp();
+        if (size < mWritten)
+            size = mWritten;
+
+        // Copy the new part through the get pointer, which is restored
+        // afterwards, so that getLine() is not disturbed.
+        ios::iostate state = mBuffer.rdstate();
+        mBuffer.clear();
+        streampos next = mBuffer.tellg();
+        mWriteBuffer.resize(size);
+        mBuffer.seekg(mWritten);
+        mBuffer.read(&mWriteBuffer[mWritten], size - mWritten);
+        mBuffer.seekg(next);
+        mBuffer.clear(state);
+
+        mWritten = size;
+    }
+    mWriter = thread(&TransactionBuffer::writeSnapshot, this, filename);
+}
+
+// Wait for background reading and writing to finish
+void TransactionBuffer::wait() {
+    if (mReader.joinable())
+        mReader.join();
+    if (mWriter.joinable())
+        mWriter.join();
+}
+
+// Read file in chunks and append complete lines to the buffer.  A line split
+// between two chunks is held back until its end arrives.  Every line, including
+// the last one, ends up terminated by a newline.
+void TransactionBuffer::readChunks(const string& filename) {
+    ifstream inputFile(filename.c_str(), ios::binary);
+    string chunk(transaction_buffer::CHUNK_SIZE, '\0');
+    string partial;
+    while (inputFile) {
+        inputFile.read(&chunk[0], chunk.size());
+        streamsize bytes = inputFile.gcount();
+        if (bytes <= 0)
+            break;
+        partial.append(chunk, 0, bytes);
+        size_t end = partial.rfind('\n');
+        if (end == string::npos)
+            continue;
+        {
+            lock_guard<mutex> lock(mReadMutex);
+            mBuffer.write(partial.data(), end + 1);
+        }
+        mReadCond.notify_one();
+        partial.erase(0, end + 1);
+    }
+    inputFile.close();
+    {
+        lock_guard<mutex> lock(mReadMutex);
+        if (!partial.empty())
+            mBuffer << partial << '\n';
+        mReadDone = true;
+    }
+    mReadCond.notify_one();
+}
+
+// Write the write buffer to file
+void TransactionBuffer::writeSnapshot(const string& filename) {
+    ofstream outputFile(filename.c_str());
+    outputFile << mWriteBuffer;
+    outputFile.close();
+}
+
 // Clear buffer
 void TransactionBuffer::clear() {
+    if (mReader.joinable())
+        mReader.join();
     mBuffer.str("");
     mBuffer.clear();
+    // the write buffer may only be reset once the writer is done with it
+    if (mWriter.joinable())
+        mWriter.join();
+    mWriteBuffer.clear();
+    mWritten = 0;
 }
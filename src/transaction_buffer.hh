@@ -22,8 +22,15 @@
 #ifndef TRANSACTION_BUFFER_HH
 #define TRANSACTION_BUFFER_HH
 
-#include <sstream>  // required for 'std::stringstream'
-#include <string>   // required for 'std::string'
+#include <sstream>             // required for 'std::stringstream'
+#include <string>              // required for 'std::string'
+#include <thread>              // required for 'std::thread'
+#include <mutex>               // required for 'std::mutex'
+#include <condition_variable>  // required for 'std::condition_variable'
+
+namespace transaction_buffer {
+    const int CHUNK_SIZE = 64 * 1024;  // size of a chunk read from file
+}
 
 // decraration of a structure holiding single transaction entry
 struct Transaction {
@@ -33,22 +40,48 @@ struct Transaction {
     float price;  // price per unit
 };
 
+// Buffer of transaction records.  Besides the blocking read() and write(), the
+// buffer can be filled by a background thread reading the file in chunks, while
+// the records already read are consumed via getLine(), and it can be written to
+// file by a background thread, while new records keep being added.  The
+// background writer keeps its own copy of the records written so far, which
+// each write extends by the records added since, and rewrites the whole file.
 class TransactionBuffer {
 private:
     std::stringstream mBuffer;  // internal string stream buffer
 
+    std::thread mReader;                // background reader of the file
+    std::mutex mReadMutex;              // guards 'mBuffer' and 'mReadDone'
+    std::condition_variable mReadCond;  // signals arrival of new records
+    bool mReadDone;                     // no more records are to come
+
+    std::thread mWriter;        // background writer of the file
+    std::string mWriteBuffer;   // copy of 'mBuffer' being written
+    std::streamoff mWritten;    // size of 'mBuffer' copied to 'mWriteBuffer'
+
+    void readChunks(const std::string& filename);  // body of the reader thread
+    void writeSnapshot(const std::string& filename);  // body of the writer
+
 public:
     TransactionBuffer();                      // default constructor
     TransactionBuffer(const std::string& s);  // constructor from given string
+    ~TransactionBuffer();                     // explicit destructor
 
     void add(Transaction t);  // add transaction record to buffer
     void add(int item, char type, int units, float price);
 
     std::stringstream& getStream();  // get reference to buffer stream
 
+    // get next record, waiting for the background reader if necessary
+    bool getLine(std::string& line);
+
     void read(const std::string& filename);         // read buffer from file
     void write(const std::string& filename) const;  // write buffer to file
 
+    void readAsync(const std::string& filename);   // start reading in background
+    void writeAsync(const std::string& filename);  // start writing in background
+    void wait();                                    // wait for background I/O
+
     void clear();  // clear buffer
 };
 